@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+# Drive minidbg through a scripted session per example program
+# and report per-operation costs collected by the built-in counters.
+#
+# Each session breaks at main, continues there and then steps through user code,
+# so every counter gets real samples. Anything minidbg writes to stderr,
+# or an operation that was never sampled, fails the benchmark.
+#
+# usage: run_benchmark.sh <build dir> [n_reads]
+
+set -e
+
+BUILD_DIR=${1:-./build}
+N_READS=${2:-200}
+OUT_DIR=${BUILD_DIR}/bench
+mkdir -p "${OUT_DIR}"
+
+# hex address of a symbol, without leading zeros
+symbol_address() {
+    local addr
+    addr=$(nm "$1" | awk -v sym="$2" '$3 == sym { print $1; exit }')
+    if [ -z "${addr}" ]; then
+        echo "$1: symbol $2 not found" >&2
+        return 1
+    fi
+    printf '0x%x' "$((16#${addr}))"
+}
+
+# session <main address> <writable address> <stepping commands...>
+session() {
+    local main_addr=$1
+    local data_addr=$2
+    shift 2
+
+    echo "break ${main_addr}"
+    echo "continue"
+    # step over push rbp; mov rbp, rsp so next/stepout read a valid frame
+    echo "stepi"
+    echo "stepi"
+    echo "info proc mappings"
+    echo "info heap"
+    echo "find 0x464c457f in all"   # "\x7fELF"
+    for _ in $(seq "${N_READS}"); do
+        echo "register read rip"
+        echo "memory read ${main_addr}"
+        echo "memory write ${data_addr} 0x0"
+    done
+    for cmd in "$@"; do
+        echo "${cmd}"
+    done
+    echo "stats"
+}
+
+cd "${BUILD_DIR}"
+
+status=0
+for spec in "hello:next" \
+            "variable:next next next" \
+            "unwinding:step step next next stepout"; do
+    prog=${spec%%:*}
+    read -r -a steps <<< "${spec#*:}"
+
+    # minidbg does not relocate DWARF addresses, so line lookups only work for non-PIE programs
+    if ! readelf -h "${prog}" | grep -q 'Type:[[:space:]]*EXEC'; then
+        echo "${prog}: not a non-PIE executable, rebuild with -no-pie" >&2
+        exit 1
+    fi
+
+    main_addr=$(symbol_address "${prog}" main)
+    data_addr=$(symbol_address "${prog}" __data_start)  # unused word in .data, safe to overwrite
+
+    rm -f "bench/${prog}".{out,err,json}
+    echo "== ${prog} (${N_READS} reads, ${steps[*]}) =="
+    session "${main_addr}" "${data_addr}" "${steps[@]}" \
+        | MINIDBG_STATS="bench/${prog}.json" ./minidbg "${prog}" \
+              > "bench/${prog}.out" 2> "bench/${prog}.err" || true
+
+    sed -n '/^operation/,$p' "bench/${prog}.out"
+    echo "json: ${OUT_DIR}/${prog}.json"
+
+    if [ -s "bench/${prog}.err" ]; then
+        echo "${prog}: session reported errors:" >&2
+        cat "bench/${prog}.err" >&2
+        status=1
+    fi
+    if [ ! -s "bench/${prog}.json" ]; then
+        echo "${prog}: no stats written" >&2
+        status=1
+    elif grep -q '"count": 0,' "bench/${prog}.json"; then
+        echo "${prog}: operations never sampled:" >&2
+        grep '"count": 0,' "bench/${prog}.json" | cut -d'"' -f2 >&2
+        status=1
+    fi
+done
+
+exit ${status}
@@ -5,6 +5,8 @@
 
 #include <cstdint>
 
+#include "stats.hpp"
+
 namespace minidbg {
     class BreakPoint {
     public:
@@ -12,6 +14,7 @@ namespace minidbg {
         BreakPoint(pid_t pid, std::intptr_t addr) : m_pid{pid}, m_addr{addr}, m_enabled{false}, m_saved_data{} {}
 
         void enable() {
+            ScopedTimer timer{perf_op::breakpoint_enable};
             auto data = ptrace(PTRACE_PEEKDATA, m_pid, m_addr, nullptr);
             m_saved_data = static_cast<uint8_t>(data & 0xff); // save bottom byte
             uint64_t int3 = 0xcc;
@@ -22,6 +25,7 @@ namespace minidbg {
         }
 
         void disable() {
+            ScopedTimer timer{perf_op::breakpoint_disable};
             auto data = ptrace(PTRACE_PEEKDATA, m_pid, m_addr, nullptr);
             auto restored_data = ((data & ~0xff) | m_saved_data);
             ptrace(PTRACE_POKEDATA, m_pid, m_addr, restored_data);
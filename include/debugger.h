@@ -11,12 +11,13 @@
 #include "dwarf/dwarf++.hh"
 
 #include <breakpoint.hpp>
+#include <memory_map.hpp>
 
 namespace minidbg {
     class Debugger {
     public:
         Debugger (std::string prog_name, pid_t pid)
-            : m_prog_name{std::move(prog_name)}, m_pid{pid} {
+            : m_prog_name{std::move(prog_name)}, m_pid{pid}, m_memory_map{pid} {
             auto fd = open(m_prog_name.c_str(), O_RDONLY);
             m_elf = elf::elf{elf::create_mmap_loader(fd)};
             m_dwarf = dwarf::dwarf{dwarf::elf::create_loader(m_elf)};
@@ -34,6 +35,12 @@ namespace minidbg {
         auto read_memory(uint64_t address) -> uint64_t;
         void write_memory(uint64_t address, uint64_t value);
 
+        void dump_memory_map();
+        void dump_memory_region(uint64_t address);
+        void dump_heap_info();
+        void dump_stats(const std::string& path);
+        void find_in_memory(const std::string& pattern, const std::string& region_name);
+
         void set_breakpoint_at_address(std::intptr_t addr);
         void set_breakpoint_at_function(const std::string& name);
         void set_breakpoint_at_source_line(const std::string& file, unsigned line);
@@ -64,6 +71,7 @@ namespace minidbg {
         pid_t m_pid;
         std::unordered_map<std::string, std::string> m_aliases;
         std::unordered_map<std::intptr_t, BreakPoint> m_breakpoints;
+        MemoryMap m_memory_map;
 
         elf::elf m_elf;
         dwarf::dwarf m_dwarf;
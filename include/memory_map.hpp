@@ -0,0 +1,234 @@
+#ifndef _MINIDBG_MEMORY_MAP_HPP
+#define _MINIDBG_MEMORY_MAP_HPP
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace minidbg {
+    struct MemoryRegion {
+        uint64_t start;
+        uint64_t end;
+        std::string perms;
+        uint64_t offset;
+        std::string dev;
+        uint64_t inode;
+        std::string path;
+
+        auto contains(uint64_t addr) const -> bool { return addr >= start && addr < end; }
+        auto size() const -> uint64_t { return end - start; }
+        auto is_readable() const -> bool { return perms.size() > 0 && perms[0] == 'r'; }
+        auto is_writable() const -> bool { return perms.size() > 1 && perms[1] == 'w'; }
+        auto is_anonymous() const -> bool { return path.empty(); }
+    };
+
+    class MemoryMap {
+    public:
+        explicit MemoryMap(pid_t pid) : m_pid{pid} {}
+
+        // tracee may have mapped or unmapped memory: next lookup re-reads /proc
+        void invalidate() { ++m_generation; }
+        auto generation() const -> uint64_t { return m_generation; }
+
+        auto regions() -> const std::vector<MemoryRegion>& {
+            refresh();
+            return m_regions;
+        }
+
+        // /proc/pid/smaps_rollup as (field, kB) pairs, in file order
+        // (kept apart from maps: the kernel walks the whole page table to produce it)
+        auto rollup() -> const std::vector<std::pair<std::string, uint64_t>>& {
+            if (m_rollup_generation != m_generation) {
+                m_rollup.clear();
+                parse_rollup(read_proc_file("smaps_rollup"));
+                m_rollup_generation = m_generation;
+            }
+            return m_rollup;
+        }
+
+        auto find_region(uint64_t addr) -> const MemoryRegion* {
+            refresh();
+
+            // mappings never overlap, so the last region starting at or before addr is the only candidate
+            auto it = std::upper_bound(m_regions.begin(), m_regions.end(), addr,
+                                       [](uint64_t a, const MemoryRegion& r) { return a < r.start; });
+            if (it == m_regions.begin()) return nullptr;
+            --it;
+            return it->contains(addr) ? &*it : nullptr;
+        }
+
+        auto is_readable(uint64_t addr, uint64_t len) -> bool {
+            auto region = find_region(addr);
+            return region && region->is_readable() && addr + len <= region->end;
+        }
+
+        // select regions by name: "all", "heap", "stack", "anon" or a path suffix
+        auto select_regions(const std::string& name) -> std::vector<MemoryRegion> {
+            std::vector<MemoryRegion> out{};
+
+            for (const auto& region : regions()) {
+                auto selected = false;
+                if (name == "all") {
+                    selected = true;
+                } else if (name == "anon") {
+                    selected = region.is_anonymous();
+                } else if (name == "heap" || name == "stack") {
+                    selected = region.path == "[" + name + "]";
+                } else if (name.size() <= region.path.size()) {
+                    selected = std::equal(name.rbegin(), name.rend(), region.path.rbegin());
+                }
+
+                if (selected) out.push_back(region);
+            }
+
+            return out;
+        }
+
+        // scan readable regions for pattern, returning the address of every match
+        auto find(const std::vector<MemoryRegion>& regions, const std::string& pattern,
+                  std::size_t max_matches = 256) -> std::vector<uint64_t> {
+            std::vector<uint64_t> matches{};
+            if (pattern.empty()) return matches;
+
+            const std::size_t chunk_size = 1 << 16;
+            const uint64_t page_size = sysconf(_SC_PAGESIZE);
+            const std::size_t overlap = pattern.size() - 1;
+            std::vector<char> buf(chunk_size + overlap);
+
+            for (const auto& region : regions) {
+                if (!region.is_readable()) continue;
+
+                // carry the tail of the previous chunk so matches spanning a chunk boundary are seen
+                std::size_t carried = 0;
+                for (auto addr = region.start; addr < region.end; ) {
+                    auto want = std::min<uint64_t>(chunk_size, region.end - addr);
+                    auto got = read_bulk(addr, buf.data() + carried, want);
+                    if (got <= 0) {
+                        // unreadable page ([vvar], guard pages): skip just that page and restart the window
+                        addr = (addr / page_size + 1) * page_size;
+                        carried = 0;
+                        continue;
+                    }
+
+                    auto len = carried + static_cast<std::size_t>(got);
+                    auto base = addr - carried;
+                    auto p = buf.data();
+                    auto end = buf.data() + len;
+
+                    // memmem is vectorised in glibc, which keeps scanning cheap on large regions
+                    while (p < end) {
+                        auto hit = static_cast<char*>(memmem(p, end - p, pattern.data(), pattern.size()));
+                        if (!hit) break;
+                        matches.push_back(base + (hit - buf.data()));
+                        if (matches.size() >= max_matches) return matches;
+                        p = hit + 1;
+                    }
+
+                    carried = std::min(overlap, len);
+                    std::memmove(buf.data(), end - carried, carried);
+                    addr += got;
+                }
+            }
+
+            return matches;
+        }
+
+    private:
+        void refresh() {
+            if (m_loaded_generation == m_generation) return;
+
+            m_regions.clear();
+            parse_maps(read_proc_file("maps"));
+            m_loaded_generation = m_generation;
+        }
+
+        // /proc files report a size of 0 and cannot be mmapped, so slurp them with large reads instead
+        auto read_proc_file(const std::string& name) -> std::string {
+            std::string out{};
+            auto path = "/proc/" + std::to_string(m_pid) + "/" + name;
+            auto fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) return out;
+
+            char buf[1 << 16];
+            ssize_t n;
+            while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+                out.append(buf, n);
+            }
+            close(fd);
+
+            return out;
+        }
+
+        void parse_maps(const std::string& text) {
+            std::size_t pos = 0;
+            while (pos < text.size()) {
+                auto eol = text.find('\n', pos);
+                if (eol == std::string::npos) eol = text.size();
+                auto line = text.substr(pos, eol - pos);
+                pos = eol + 1;
+
+                // 00400000-00452000 r-xp 00000000 08:02 173521      /usr/bin/dbus-daemon
+                unsigned long long start, end, offset, inode;
+                char perms[8], dev[16];
+                int path_pos = 0;
+                if (std::sscanf(line.c_str(), "%llx-%llx %7s %llx %15s %llu %n",
+                                &start, &end, perms, &offset, dev, &inode, &path_pos) < 6) {
+                    continue;
+                }
+
+                MemoryRegion region{start, end, perms, offset, dev, inode, {}};
+                if (path_pos > 0 && static_cast<std::size_t>(path_pos) < line.size()) {
+                    region.path = line.substr(path_pos);
+                }
+                m_regions.push_back(std::move(region));
+            }
+
+            // the kernel already emits maps in address order, but lookups rely on it
+            std::sort(m_regions.begin(), m_regions.end(),
+                      [](const MemoryRegion& a, const MemoryRegion& b) { return a.start < b.start; });
+        }
+
+        void parse_rollup(const std::string& text) {
+            std::size_t pos = 0;
+            while (pos < text.size()) {
+                auto eol = text.find('\n', pos);
+                if (eol == std::string::npos) eol = text.size();
+                auto line = text.substr(pos, eol - pos);
+                pos = eol + 1;
+
+                // Rss:                 884 kB (the leading range/[rollup] header line has no " kB" suffix)
+                char field[64];
+                unsigned long long kb;
+                if (line.size() > 3 && line.compare(line.size() - 3, 3, " kB") == 0
+                    && std::sscanf(line.c_str(), "%63[^:]: %llu", field, &kb) == 2) {
+                    m_rollup.emplace_back(field, kb);
+                }
+            }
+        }
+
+        // one process_vm_readv call per chunk instead of one PTRACE_PEEKDATA per word
+        auto read_bulk(uint64_t addr, char* out, std::size_t len) -> ssize_t {
+            iovec local{out, len};
+            iovec remote{reinterpret_cast<void*>(addr), len};
+            return process_vm_readv(m_pid, &local, 1, &remote, 1, 0);
+        }
+
+        pid_t m_pid;
+        uint64_t m_generation = 1;
+        uint64_t m_loaded_generation = 0;
+        uint64_t m_rollup_generation = 0;
+        std::vector<MemoryRegion> m_regions;
+        std::vector<std::pair<std::string, uint64_t>> m_rollup;
+    };
+}
+
+#endif
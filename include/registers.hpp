@@ -8,6 +8,8 @@
 #include <array>
 #include <algorithm>
 
+#include "stats.hpp"
+
 namespace minidbg {
     enum class reg {
         rax, rbx, rcx, rdx,
@@ -59,6 +61,7 @@ namespace minidbg {
     }};
 
     uint64_t get_register_value(pid_t pid, reg r) {
+        ScopedTimer timer{perf_op::get_register_value};
         user_regs_struct regs;
         ptrace(PTRACE_GETREGS, pid, nullptr, &regs);
         auto it = std::find_if(begin(g_register_descriptors), end(g_register_descriptors),
@@ -0,0 +1,122 @@
+#ifndef _MINIDBG_STATS_HPP
+#define _MINIDBG_STATS_HPP
+
+#include <x86intrin.h>
+
+#include <cstdint>
+#include <string>
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <iomanip>
+
+namespace minidbg {
+    enum class perf_op {
+        read_memory, write_memory,
+        get_register_value,
+        get_line_entry_from_pc, get_function_from_pc,
+        breakpoint_enable, breakpoint_disable,
+        wait_for_signal, print_source
+    };
+
+    constexpr std::size_t n_perf_ops = 9;
+
+    const std::array<std::string, n_perf_ops> g_perf_op_names {{
+        "read_memory", "write_memory",
+        "get_register_value",
+        "get_line_entry_from_pc", "get_function_from_pc",
+        "breakpoint_enable", "breakpoint_disable",
+        "wait_for_signal", "print_source"
+    }};
+
+    struct perf_counter {
+        uint64_t count;
+        uint64_t cycles;
+        uint64_t max_cycles;
+    };
+
+    // per-thread, so recording a span is a couple of adds with no locking
+    inline auto perf_counters() -> std::array<perf_counter, n_perf_ops>& {
+        thread_local std::array<perf_counter, n_perf_ops> counters{};
+        return counters;
+    }
+
+    // tsc and wall clock at startup, used to turn cycles into nanoseconds when reporting
+    struct perf_clock_origin {
+        uint64_t tsc;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    inline auto perf_origin() -> const perf_clock_origin& {
+        static const perf_clock_origin origin{__rdtsc(), std::chrono::steady_clock::now()};
+        return origin;
+    }
+
+    inline auto perf_ns_per_cycle() -> double {
+        auto cycles = __rdtsc() - perf_origin().tsc;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - perf_origin().time).count();
+        return cycles ? static_cast<double>(ns) / cycles : 0.0;
+    }
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(perf_op op) : m_op{op}, m_start{__rdtsc()} {}
+
+        ~ScopedTimer() {
+            auto elapsed = __rdtsc() - m_start;
+            auto& counter = perf_counters()[static_cast<std::size_t>(m_op)];
+            ++counter.count;
+            counter.cycles += elapsed;
+            if (elapsed > counter.max_cycles) counter.max_cycles = elapsed;
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        perf_op m_op;
+        uint64_t m_start;
+    };
+
+    inline void reset_perf_counters() {
+        perf_counters().fill(perf_counter{});
+    }
+
+    inline void print_perf_counters(std::ostream& os) {
+        auto ns_per_cycle = perf_ns_per_cycle();
+
+        os << std::dec << std::setfill(' ') << std::left
+           << std::setw(24) << "operation" << std::right
+           << std::setw(10) << "count" << std::setw(16) << "total(us)"
+           << std::setw(14) << "avg(ns)" << std::setw(14) << "max(ns)" << std::endl;
+
+        for (std::size_t i = 0; i < n_perf_ops; ++i) {
+            const auto& counter = perf_counters()[i];
+            auto avg = counter.count ? counter.cycles * ns_per_cycle / counter.count : 0.0;
+
+            os << std::left << std::setw(24) << g_perf_op_names[i] << std::right
+               << std::setw(10) << counter.count
+               << std::setw(16) << static_cast<uint64_t>(counter.cycles * ns_per_cycle / 1000)
+               << std::setw(14) << static_cast<uint64_t>(avg)
+               << std::setw(14) << static_cast<uint64_t>(counter.max_cycles * ns_per_cycle) << std::endl;
+        }
+    }
+
+    inline void dump_perf_counters_json(std::ostream& os) {
+        auto ns_per_cycle = perf_ns_per_cycle();
+
+        os << std::dec << "{\n  \"ns_per_cycle\": " << ns_per_cycle << ",\n  \"operations\": {";
+        for (std::size_t i = 0; i < n_perf_ops; ++i) {
+            const auto& counter = perf_counters()[i];
+            os << (i ? "," : "") << "\n    \"" << g_perf_op_names[i] << "\": {"
+               << "\"count\": " << counter.count
+               << ", \"cycles\": " << counter.cycles
+               << ", \"max_cycles\": " << counter.max_cycles
+               << ", \"total_ns\": " << static_cast<uint64_t>(counter.cycles * ns_per_cycle) << "}";
+        }
+        os << "\n  }\n}" << std::endl;
+    }
+}
+
+#endif
@@ -10,6 +10,9 @@
 #include <fstream>
 #include <iomanip>
 #include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 
 #include "linenoise.h"
 
@@ -30,6 +33,16 @@ std::vector<std::string> split(const std::string &s, char delimiter) {
     return out;
 }
 
+std::string to_hex(uint64_t value) {
+    std::stringstream ss;
+    ss << std::hex << value;
+    return ss.str();
+}
+
+bool is_hex(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isxdigit(c); });
+}
+
 bool is_suffix(const std::string& s, const std::string& of) {
     if (s.size() > of.size()) return false;
     auto diff = of.size() - s.size();
@@ -43,10 +56,19 @@ void Debugger::run() {
 
     char* line = nullptr;
     while ((line = linenoise("minidbg> ")) != nullptr) {
-        handle_command(line);
+        try {
+            handle_command(line);
+        } catch (const std::exception& e) {
+            // e.g. no line entry for pc inside ld.so: report it and keep the session (and scripts) alive
+            std::cerr << e.what() << std::endl;
+        }
         linenoiseHistoryAdd(line);
         linenoiseFree(line);
     }
+
+    if (auto path = std::getenv("MINIDBG_STATS")) {
+        dump_stats(path);
+    }
 }
 
 void Debugger::handle_command(const std::string& line) {
@@ -73,11 +95,46 @@ void Debugger::handle_command(const std::string& line) {
         } else if (is_alias(command, "memory")) {
             std::string addr {args[2], 2};      // assume 0xADDRESS
 
-            if (is_alias(args[1], "read")) {
-                std::cout << std::hex << read_memory(std::stol(addr, 0, 16)) << std::endl;
+            auto address = std::stoul(addr, 0, 16);
+
+            if (!m_memory_map.is_readable(address, sizeof(uint64_t))) {
+                std::cerr << "Cannot access memory at address 0x" << std::hex << address << std::endl;
+            } else if (is_alias(args[1], "read")) {
+                std::cout << std::hex << read_memory(address) << std::endl;
             } else if (is_alias(args[1], "write")) {
                 std::string val {args[3], 2};   // assume 0xVAL
-                write_memory(std::stol(addr, 0, 16), std::stol(val, 0, 16));
+                write_memory(address, std::stoul(val, 0, 16));
+            }
+        } else if (is_alias(command, "info")) {
+            if (args.size() > 2 && is_alias(args[1], "proc") && is_alias(args[2], "mappings")) {
+                dump_memory_map();
+            } else if (args.size() > 2 && is_alias(args[1], "region")) {
+                std::string addr {args[2], std::min<std::size_t>(2, args[2].size())};  // assume 0xADDRESS
+                if (is_hex(addr) && addr.size() <= 16) {
+                    dump_memory_region(std::stoul(addr, 0, 16));
+                } else {
+                    std::cerr << "Invalid address " << args[2] << std::endl;
+                }
+            } else if (args.size() > 1 && is_alias(args[1], "heap")) {
+                dump_heap_info();
+            } else {
+                std::cerr << "Unknown info command\n";
+            }
+        } else if (is_alias(command, "find")) {
+            // find PATTERN [in REGION]
+            if (args.size() < 2) {
+                std::cerr << "Usage: find PATTERN [in REGION]\n";
+                return;
+            }
+            auto region_name = (args.size() > 3 && args[2] == "in") ? args[3] : std::string{"all"};
+            find_in_memory(args[1], region_name);
+        } else if (is_alias(command, "stats")) {
+            if (args.size() > 1 && args[1] == "reset") {
+                reset_perf_counters();
+            } else if (args.size() > 1) {
+                dump_stats(args[1]);
+            } else {
+                print_perf_counters(std::cout);
             }
         } else if (is_alias(command, "stepin")) {
             single_step_instruction_with_breakpoint_check();
@@ -104,13 +161,100 @@ void Debugger::dump_registers() {
 }
 
 uint64_t Debugger::read_memory(uint64_t address) {
+    ScopedTimer timer{perf_op::read_memory};
     return ptrace(PTRACE_PEEKDATA, m_pid, address, nullptr);
 }
 
 void Debugger::write_memory(uint64_t address, uint64_t value) {
+    ScopedTimer timer{perf_op::write_memory};
     ptrace(PTRACE_POKEDATA, m_pid, address, value);
 }
 
+void Debugger::dump_memory_map() {
+    std::cout << std::setfill(' ')
+              << std::setw(18) << "Start Addr" << " " << std::setw(18) << "End Addr" << " "
+              << std::setw(10) << "Size" << " " << std::setw(10) << "Offset" << " Perms  objfile" << std::endl;
+
+    for (const auto& region : m_memory_map.regions()) {
+        std::cout << std::hex
+                  << std::setw(18) << ("0x" + to_hex(region.start)) << " "
+                  << std::setw(18) << ("0x" + to_hex(region.end)) << " "
+                  << std::setw(10) << ("0x" + to_hex(region.size())) << " "
+                  << std::setw(10) << ("0x" + to_hex(region.offset)) << " "
+                  << region.perms << "   " << region.path << std::endl;
+    }
+}
+
+void Debugger::dump_memory_region(uint64_t address) {
+    auto region = m_memory_map.find_region(address);
+    if (!region) {
+        std::cout << "0x" << std::hex << address << " is not mapped" << std::endl;
+        return;
+    }
+
+    std::cout << "0x" << std::hex << address << " is in 0x" << region->start << "-0x" << region->end
+              << " " << region->perms << " " << (region->is_anonymous() ? "[anon]" : region->path)
+              << " +0x" << address - region->start << std::endl;
+}
+
+void Debugger::dump_heap_info() {
+    uint64_t heap_size = 0;
+    uint64_t anon_size = 0;
+    for (const auto& region : m_memory_map.regions()) {
+        if (region.path == "[heap]") heap_size += region.size();
+        if (region.is_anonymous()) anon_size += region.size();
+    }
+
+    std::cout << std::dec
+              << "heap: " << heap_size / 1024 << " kB" << std::endl
+              << "anonymous mappings: " << anon_size / 1024 << " kB" << std::endl;
+
+    for (const auto& field : m_memory_map.rollup()) {
+        std::cout << field.first << ": " << field.second << " kB" << std::endl;
+    }
+}
+
+void Debugger::find_in_memory(const std::string& pattern, const std::string& region_name) {
+    std::string bytes{};
+
+    if (pattern.size() > 2 && pattern.compare(0, 2, "0x") == 0) {
+        // hex values are searched as little-endian integers of their written width
+        std::string digits {pattern, 2};
+        if (!is_hex(digits)) {
+            std::cerr << "Invalid hex pattern " << pattern << std::endl;
+            return;
+        }
+        if (digits.size() % 2) digits.insert(0, "0");
+        for (auto i = digits.size(); i > 0; i -= 2) {
+            bytes.push_back(static_cast<char>(std::stoul(digits.substr(i - 2, 2), 0, 16)));
+        }
+    } else {
+        bytes = pattern;
+    }
+
+    auto regions = m_memory_map.select_regions(region_name);
+    if (regions.empty()) {
+        std::cerr << "No memory region matches " << region_name << std::endl;
+        return;
+    }
+
+    auto matches = m_memory_map.find(regions, bytes);
+    for (auto addr : matches) {
+        std::cout << "0x" << std::hex << addr << std::endl;
+    }
+    std::cout << std::dec << matches.size() << " pattern(s) found." << std::endl;
+}
+
+void Debugger::dump_stats(const std::string& path) {
+    std::ofstream file {path};
+    if (!file) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return;
+    }
+
+    dump_perf_counters_json(file);
+}
+
 void Debugger::set_breakpoint_at_address(std::intptr_t addr) {
     std::cout << "Set breakpoint at address 0x" << std::hex << addr << std::endl;
     BreakPoint bp {m_pid, addr};
@@ -259,7 +403,14 @@ void Debugger::step_over_breakpoint() {
 void Debugger::wait_for_signal() {
     int wait_status;
     auto options = 0;
-    waitpid(m_pid, &wait_status, options);
+    {
+        // only time the wait itself, handle_sigtrap is accounted for by its own spans
+        ScopedTimer timer{perf_op::wait_for_signal};
+        waitpid(m_pid, &wait_status, options);
+    }
+
+    // the tracee ran, so it may have called mmap/munmap/brk since the last snapshot
+    m_memory_map.invalidate();
 
     auto siginfo = get_signal_info();
 
@@ -303,6 +454,7 @@ void Debugger::handle_sigtrap(siginfo_t info) {
 }
 
 dwarf::die Debugger::get_function_from_pc(uint64_t pc) {
+    ScopedTimer timer{perf_op::get_function_from_pc};
     for (auto &cu : m_dwarf.compilation_units()) {
         if (die_pc_range(cu.root()).contains(pc)) {
             for (const auto& die : cu.root()) {
@@ -319,6 +471,7 @@ dwarf::die Debugger::get_function_from_pc(uint64_t pc) {
 }
 
 dwarf::line_table::iterator Debugger::get_line_entry_from_pc(uint64_t pc) {
+    ScopedTimer timer{perf_op::get_line_entry_from_pc};
     for (auto &cu : m_dwarf.compilation_units()) {
         if (die_pc_range(cu.root()).contains(pc)) {
             auto &lt = cu.get_line_table();
@@ -335,6 +488,7 @@ dwarf::line_table::iterator Debugger::get_line_entry_from_pc(uint64_t pc) {
 }
 
 void Debugger::print_source(const std::string& file_name, unsigned line, unsigned n_lines_context) {
+    ScopedTimer timer{perf_op::print_source};
     std::ifstream file {file_name};
 
     // Work out a window around the desired line
@@ -396,6 +550,15 @@ inline void Debugger::init() {
     this->set_alias("read", "read");
     this->set_alias("w", "write");
     this->set_alias("write", "write");
+
+    this->set_alias("i", "info");
+    this->set_alias("info", "info");
+    this->set_alias("find", "find");
+    this->set_alias("proc", "proc");
+    this->set_alias("mappings", "mappings");
+    this->set_alias("region", "region");
+    this->set_alias("heap", "heap");
+    this->set_alias("stats", "stats");
 }
 
 inline bool Debugger::is_alias(const std::string& input, const std::string& command) {
@@ -423,6 +586,7 @@ int main(int argc, char* argv[]) {
     }
 
     auto prog = argv[1];
+    perf_origin();  // start the tsc calibration window as early as possible
 
     auto pid = fork();
     if (pid == 0) {